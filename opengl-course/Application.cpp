@@ -6,6 +6,9 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
 
 #include "Renderer.h"
 
@@ -15,6 +18,11 @@
 #include "VertexArray.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "MemoryTracker.h"
+#include "GLTrace.h"
+#include "FrameBuffer.h"
+#include "FrameScheduler.h"
+#include "FramePacer.h"
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
@@ -23,7 +31,7 @@
 #include "imgui/imgui_impl_glfw.h"
 #include "imgui/imgui_impl_opengl3.h"
 
-int main(void) {
+int main(int argc, char** argv) {
     // Initialize GLFW
     if (!glfwInit()) {
         return -1;
@@ -44,7 +52,6 @@ int main(void) {
     
     // Attach window to OpenGL context
     glfwMakeContextCurrent(window);
-    glfwSwapInterval(1);
     
     if (glewInit() != GLEW_OK) {
         std::cout << "Error! glew it not ok" << std::endl;
@@ -52,6 +59,40 @@ int main(void) {
     
     std::cout << "GL Version " << glGetString(GL_VERSION) << std::endl;
     
+    // --capture <file> [frames] records the GL calls from startup for replay
+    // --continuous renders every vsync instead of only when something changed
+    // --swap-interval, --frames-in-flight, --fps and --late-input configure pacing
+    bool onDemand = true;
+    int swapInterval = 1;
+    FramePacer pacer;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--continuous")) {
+            onDemand = false;
+        } else if (!strcmp(argv[i], "--swap-interval") && i + 1 < argc) {
+            swapInterval = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--frames-in-flight") && i + 1 < argc) {
+            pacer.SetMaxFramesInFlight((unsigned int)atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--fps") && i + 1 < argc) {
+            pacer.SetTargetFPS((float)atof(argv[++i]));
+        } else if (!strcmp(argv[i], "--late-input")) {
+            pacer.SetLateInputSampling(true);
+        } else if (!strcmp(argv[i], "--capture") && i + 1 < argc) {
+            const char* tracePath = argv[++i];
+            unsigned int frames = 300;
+            if (i + 1 < argc && isdigit(argv[i + 1][0])) {
+                frames = (unsigned int)atoi(argv[++i]);
+            }
+            int width, height;
+            glfwGetFramebufferSize(window, &width, &height);
+            GLTrace::BeginCapture(tracePath, frames, width, height);
+        }
+    }
+    
+    glfwSwapInterval(swapInterval);
+    
+    // Created before ImGui so its input callbacks get chained
+    FrameScheduler scheduler(window, onDemand);
+    
     ImGui::CreateContext();
     ImGui::StyleColorsDark();
     ImGui_ImplGlfw_InitForOpenGL(window, true);
@@ -85,7 +126,7 @@ int main(void) {
     va.AddBuffer(vb, layout);
     
     // Tell OpenGL how each Vertex are linked to create the rectangle
-    IndexBuffer ib(indices, sizeof(indices));
+    IndexBuffer ib(indices, 6);
     
     glm::mat4 projection = glm::ortho<float>(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 1.0f);
     glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0));
@@ -106,6 +147,32 @@ int main(void) {
     
     Renderer renderer;
     
+    // The quads are drawn into an offscreen target and only redrawn when they change
+    int width, height;
+    glfwGetFramebufferSize(window, &width, &height);
+    FrameBuffer sceneTarget(width, height);
+    bool sceneDirty = true;
+    
+    // Fullscreen rectangle to composite the cached scene onto the window
+    float compositePositions[] = {
+        -1.0f, -1.0f, 0.0f, 0.0f, // 0
+         1.0f, -1.0f, 1.0f, 0.0f, // 1
+         1.0f,  1.0f, 1.0f, 1.0f, // 2
+        -1.0f,  1.0f, 0.0f, 1.0f // 3
+    };
+    
+    VertexArray compositeVa;
+    VertexBuffer compositeVb(compositePositions, 4 * 4 * sizeof(float));
+    compositeVa.AddBuffer(compositeVb, layout);
+    
+    Shader compositeShader("resources/shaders/Composite.shader");
+    compositeShader.Bind();
+    compositeShader.SetUniform1i("u_Texture", 0);
+    
+    compositeVa.Unbind();
+    compositeVb.Unbind();
+    compositeShader.Unbind();
+    
     glm::vec3 translationA(200, 200, 0);
     glm::vec3 translationB(400, 200, 0);
     
@@ -113,31 +180,28 @@ int main(void) {
     float increment = 0.05f;
     
     while(!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+        // Late input sampling waits for the GPU before polling, so the
+        // input and transforms are as fresh as possible at submission
+        if (pacer.IsLateInputSampling()) {
+            pacer.WaitForFrameSlot();
+        }
+        
+        // Sleeps until input arrives when rendering on demand
+        if (!scheduler.WaitForFrame()) {
+            continue;
+        }
+        pacer.BeginFrame();
         
-        renderer.Clear();
+        if (!pacer.IsLateInputSampling()) {
+            pacer.WaitForFrameSlot();
+        }
+        MemoryTracker::Get().NewFrame();
         
         // Start the Dear ImGui frame
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
         
-        {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), translationA);
-            glm::mat4 mvp = projection * view * model;
-            shader.Bind();
-            shader.SetUniformMat4f("u_MVP", mvp);
-            renderer.Draw(va, ib, shader);
-        }
-        
-        {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), translationB);
-            glm::mat4 mvp = projection * view * model;
-            shader.Bind();
-            shader.SetUniformMat4f("u_MVP", mvp);
-            renderer.Draw(va, ib, shader);
-        }
-        
         // Logic to change color each frame
         if (r > 1.0f) {
             increment = -0.05f;
@@ -146,21 +210,96 @@ int main(void) {
         }
         r += increment;
         
+        // Build the UI first so slider edits reach the scene in the same frame
         {
             ImGui::Begin("Transform");
-            ImGui::SliderFloat3("Translation A", &translationA.x, 0.0f, 960.0f);
-            ImGui::SliderFloat3("Translation B", &translationB.x, 0.0f, 960.0f);
+            sceneDirty |= ImGui::SliderFloat3("Translation A", &translationA.x, 0.0f, 960.0f);
+            sceneDirty |= ImGui::SliderFloat3("Translation B", &translationB.x, 0.0f, 960.0f);
+            ImGui::End();
+        }
+        
+        MemoryTracker::Get().OnImGuiRender();
+        scheduler.OnImGuiRender();
+        
+        {
+            ImGui::Begin("Pacing");
+            int framesInFlight = pacer.GetMaxFramesInFlight();
+            if (ImGui::SliderInt("Frames in flight", &framesInFlight, 1, FRAMEPACER_MAX_FRAMES_IN_FLIGHT)) {
+                pacer.SetMaxFramesInFlight(framesInFlight);
+            }
+            float fps = pacer.GetTargetFPS();
+            // Dragging below the minimum turns the limiter off rather than freezing the UI
+            if (ImGui::SliderFloat("FPS limit", &fps, 0.0f, 240.0f, fps >= FRAMEPACER_MIN_FPS ? "%.0f" : "Off")) {
+                pacer.SetTargetFPS(fps);
+            }
+            bool lateInput = pacer.IsLateInputSampling();
+            if (ImGui::Checkbox("Late input sampling", &lateInput)) {
+                pacer.SetLateInputSampling(lateInput);
+            }
+            ImGui::Text("Latency: %.2f ms (avg %.2f, max %.2f)", pacer.GetLastLatency(), pacer.GetAverageLatency(), pacer.GetMaxLatency());
+            ImGui::Text("Waited:  %.2f ms", pacer.GetWaitTime());
+            ImGui::PlotLines("Latency ms", pacer.GetLatencyHistory(), pacer.GetLatencyCount(), 0, NULL, 0.0f, FLT_MAX, ImVec2(0, 60));
             ImGui::End();
         }
         
+        // A minimized window has a 0x0 framebuffer, there is nothing to draw into
+        glfwGetFramebufferSize(window, &width, &height);
+        bool visible = width > 0 && height > 0;
+        if (visible && (width != sceneTarget.GetWidth() || height != sceneTarget.GetHeight())) {
+            sceneTarget.Resize(width, height);
+            sceneDirty = true;
+        }
+        
+        if (visible && sceneDirty) {
+            sceneTarget.Bind();
+            renderer.Clear();
+            
+            // Binding marks the texture as used, reloading it if it was evicted
+            texture.Bind(0);
+            
+            {
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), translationA);
+                glm::mat4 mvp = projection * view * model;
+                shader.Bind();
+                shader.SetUniformMat4f("u_MVP", mvp);
+                renderer.Draw(va, ib, shader);
+            }
+            
+            {
+                glm::mat4 model = glm::translate(glm::mat4(1.0f), translationB);
+                glm::mat4 mvp = projection * view * model;
+                shader.Bind();
+                shader.SetUniformMat4f("u_MVP", mvp);
+                renderer.Draw(va, ib, shader);
+            }
+            
+            sceneTarget.Unbind();
+            sceneDirty = false;
+        }
+        
+        // Composite the cached scene, it is opaque so no clear or blending is needed
+        if (visible) {
+            GLCall(glViewport(0, 0, width, height));
+            GLCall(glDisable(GL_BLEND));
+            sceneTarget.BindTexture(0);
+            renderer.Draw(compositeVa, ib, compositeShader);
+            GLCall(glEnable(GL_BLEND));
+        }
+        
         // ImGui Render
         ImGui::Render();
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
         
         // GLFW specific things to clear buffers and get input events
         glfwSwapBuffers(window);
+        pacer.EndFrame();
+        scheduler.EndFrame();
+        GLTrace::EndFrame();
     }
     
+    // Flush a partial capture if the window was closed early
+    GLTrace::EndCapture();
+    
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     glfwTerminate();
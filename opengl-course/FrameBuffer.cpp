@@ -0,0 +1,87 @@
+//
+//  FrameBuffer.cpp
+//  opengl-course
+//
+
+#include "FrameBuffer.h"
+
+#include <iostream>
+
+#include "Renderer.h"
+#include "MemoryTracker.h"
+
+FrameBuffer::FrameBuffer(int width, int height)
+    : m_RendererID(0), m_ColorAttachment(0), m_Width(width), m_Height(height)
+{
+    Create();
+}
+
+FrameBuffer::~FrameBuffer() {
+    Destroy();
+}
+
+void FrameBuffer::Create() {
+    // A zero-size attachment is never complete, minimized windows report 0x0
+    if (m_Width <= 0 || m_Height <= 0) {
+        std::cout << "Frame buffer can't be " << m_Width << "x" << m_Height << "!" << std::endl;
+        return;
+    }
+
+    GLCall(glGenTextures(1, &m_ColorAttachment));
+    GLCall(glBindTexture(GL_TEXTURE_2D, m_ColorAttachment));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+
+    GLCall(glGenFramebuffers(1, &m_RendererID));
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ColorAttachment, 0));
+    GLCall(GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cout << "Frame buffer is incomplete (" << status << ")!" << std::endl;
+    }
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+
+    MemoryTracker::Get().Allocate(MemoryCategory::RenderTarget, GetSize());
+}
+
+void FrameBuffer::Destroy() {
+    if (!m_RendererID) {
+        return;
+    }
+
+    GLCall(glDeleteFramebuffers(1, &m_RendererID));
+    GLCall(glDeleteTextures(1, &m_ColorAttachment));
+    MemoryTracker::Get().Free(MemoryCategory::RenderTarget, GetSize());
+    m_RendererID = 0;
+    m_ColorAttachment = 0;
+}
+
+void FrameBuffer::Resize(int width, int height) {
+    // Keep the current target rather than replacing it with an unusable one
+    if ((width == m_Width && height == m_Height) || width <= 0 || height <= 0) {
+        return;
+    }
+
+    Destroy();
+    m_Width = width;
+    m_Height = height;
+    Create();
+}
+
+void FrameBuffer::Bind() const {
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+    GLCall(glViewport(0, 0, m_Width, m_Height));
+}
+
+void FrameBuffer::Unbind() const {
+    GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void FrameBuffer::BindTexture(unsigned int slot /*= 0*/) const {
+    GLCall(glActiveTexture(GL_TEXTURE0 + slot));
+    GLCall(glBindTexture(GL_TEXTURE_2D, m_ColorAttachment));
+}
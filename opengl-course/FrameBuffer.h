@@ -0,0 +1,37 @@
+//
+//  FrameBuffer.h
+//  opengl-course
+//
+
+#ifndef FrameBuffer_h
+#define FrameBuffer_h
+
+#include <cstddef>
+
+class FrameBuffer {
+private:
+    unsigned int m_RendererID;
+    unsigned int m_ColorAttachment;
+    int m_Width, m_Height;
+public:
+    FrameBuffer(int width, int height);
+    ~FrameBuffer();
+
+    // Recreates the color attachment, its previous content is lost. Zero
+    // sizes are ignored.
+    void Resize(int width, int height);
+
+    // Binds the frame buffer and sets the viewport to its size
+    void Bind() const;
+    void Unbind() const;
+    void BindTexture(unsigned int slot = 0) const;
+
+    inline int GetWidth() const { return m_Width; }
+    inline int GetHeight() const { return m_Height; }
+    inline size_t GetSize() const { return (size_t)m_Width * m_Height * 4; }
+private:
+    void Create();
+    void Destroy();
+};
+
+#endif /* FrameBuffer_h */
@@ -0,0 +1,140 @@
+//
+//  FramePacer.cpp
+//  opengl-course
+//
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+// GL calls here don't go through GLCall so the replay tool can use the pacer
+// without linking the renderer
+
+FramePacer::FramePacer(unsigned int maxFramesInFlight /*= 2*/, float targetFPS /*= 0.0f*/)
+    : m_MaxFramesInFlight(1), m_TargetFrameTime(0.0), m_LateInputSampling(false), m_LastFrameTime(Now()),
+      m_GPUStart(0), m_Latency(), m_LatencyCount(0), m_WaitTime(0.0f)
+{
+    SetMaxFramesInFlight(maxFramesInFlight);
+    SetTargetFPS(targetFPS);
+
+    m_FreeQueries.resize(FRAMEPACER_MAX_FRAMES_IN_FLIGHT);
+    glGenQueries(FRAMEPACER_MAX_FRAMES_IN_FLIGHT, m_FreeQueries.data());
+}
+
+FramePacer::~FramePacer() {
+    for (const FramePacerFrame& frame : m_Frames) {
+        glDeleteSync(frame.Fence);
+        m_FreeQueries.push_back(frame.Query);
+    }
+    glDeleteQueries((GLsizei)m_FreeQueries.size(), m_FreeQueries.data());
+}
+
+void FramePacer::SetMaxFramesInFlight(unsigned int frames) {
+    m_MaxFramesInFlight = std::min(std::max(frames, 1u), (unsigned int)FRAMEPACER_MAX_FRAMES_IN_FLIGHT);
+}
+
+void FramePacer::SetTargetFPS(float fps) {
+    m_TargetFrameTime = fps >= FRAMEPACER_MIN_FPS ? 1.0 / fps : 0.0;
+}
+
+void FramePacer::WaitForFrameSlot() {
+    double start = Now();
+
+    while (!m_Frames.empty()) {
+        const FramePacerFrame& frame = m_Frames.front();
+        bool mustWait = m_Frames.size() >= m_MaxFramesInFlight;
+
+        GLuint64 timeout = mustWait ? 100000000 : 0; // 100ms, then check again
+        GLenum result = glClientWaitSync(frame.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            if (mustWait) {
+                continue;
+            }
+            break;
+        }
+
+        if (result != GL_WAIT_FAILED) {
+            Retire(frame);
+        }
+        glDeleteSync(frame.Fence);
+        m_FreeQueries.push_back(frame.Query);
+        m_Frames.pop_front();
+    }
+
+    if (m_TargetFrameTime > 0.0) {
+        double deadline = m_LastFrameTime + m_TargetFrameTime;
+        // Sleep most of the way and spin the rest, sleeps overshoot by around a millisecond
+        double sleep = deadline - Now() - 0.002;
+        if (sleep > 0.0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(sleep));
+        }
+        while (Now() < deadline) {
+            std::this_thread::yield();
+        }
+
+        // Don't try to catch up after a long frame
+        double now = Now();
+        m_LastFrameTime = (now - deadline > m_TargetFrameTime) ? now : deadline;
+    }
+
+    m_WaitTime = (float)((Now() - start) * 1000.0);
+}
+
+void FramePacer::BeginFrame() {
+    glGetInteger64v(GL_TIMESTAMP, &m_GPUStart);
+}
+
+void FramePacer::EndFrame() {
+    FramePacerFrame frame = { nullptr, 0, m_GPUStart };
+    if (!m_FreeQueries.empty()) {
+        frame.Query = m_FreeQueries.back();
+        m_FreeQueries.pop_back();
+        glQueryCounter(frame.Query, GL_TIMESTAMP);
+    }
+    frame.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_Frames.push_back(frame);
+}
+
+void FramePacer::Retire(const FramePacerFrame& frame) {
+    if (!frame.Query) {
+        return;
+    }
+
+    // The fence was signaled after the timestamp, so the result is available
+    GLint64 gpuEnd = 0;
+    glGetQueryObjecti64v(frame.Query, GL_QUERY_RESULT, &gpuEnd);
+    float latency = (float)((gpuEnd - frame.GPUStart) / 1000000.0);
+
+    if (m_LatencyCount < FRAMEPACER_HISTORY) {
+        m_Latency[m_LatencyCount++] = latency;
+    } else {
+        std::rotate(m_Latency, m_Latency + 1, m_Latency + FRAMEPACER_HISTORY);
+        m_Latency[FRAMEPACER_HISTORY - 1] = latency;
+    }
+}
+
+float FramePacer::GetLastLatency() const {
+    return m_LatencyCount > 0 ? m_Latency[m_LatencyCount - 1] : 0.0f;
+}
+
+float FramePacer::GetAverageLatency() const {
+    if (m_LatencyCount == 0) {
+        return 0.0f;
+    }
+
+    float total = 0.0f;
+    for (unsigned int i = 0; i < m_LatencyCount; i++) {
+        total += m_Latency[i];
+    }
+    return total / m_LatencyCount;
+}
+
+float FramePacer::GetMaxLatency() const {
+    return m_LatencyCount > 0 ? *std::max_element(m_Latency, m_Latency + m_LatencyCount) : 0.0f;
+}
+
+double FramePacer::Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
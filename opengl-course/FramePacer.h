@@ -0,0 +1,79 @@
+//
+//  FramePacer.h
+//  opengl-course
+//
+
+#ifndef FramePacer_h
+#define FramePacer_h
+
+#include <GL/glew.h>
+
+#include <deque>
+#include <vector>
+
+#define FRAMEPACER_MAX_FRAMES_IN_FLIGHT 3
+#define FRAMEPACER_HISTORY 120
+// Lower limits would stall input handling for most of a second, so they turn the limiter off
+#define FRAMEPACER_MIN_FPS 10.0f
+
+struct FramePacerFrame {
+    GLsync Fence;
+    GLuint Query;
+    GLint64 GPUStart;
+};
+
+// Bounds how far the CPU runs ahead of the GPU with one fence per frame and
+// measures the latency from input sampling to GPU completion with timestamp
+// queries. It only uses the current context, it doesn't touch the window.
+//
+// Per frame: sample input, BeginFrame(), WaitForFrameSlot(), render, swap,
+// EndFrame(). With late input sampling the wait moves before the input poll:
+// WaitForFrameSlot(), sample input, BeginFrame(), render, swap, EndFrame().
+class FramePacer {
+private:
+    unsigned int m_MaxFramesInFlight;
+    double m_TargetFrameTime;
+    bool m_LateInputSampling;
+    double m_LastFrameTime;
+
+    std::deque<FramePacerFrame> m_Frames;
+    std::vector<GLuint> m_FreeQueries;
+    GLint64 m_GPUStart;
+
+    float m_Latency[FRAMEPACER_HISTORY];
+    unsigned int m_LatencyCount;
+    float m_WaitTime;
+public:
+    FramePacer(unsigned int maxFramesInFlight = 2, float targetFPS = 0.0f);
+    ~FramePacer();
+
+    // Blocks until fewer than the maximum frames are in flight, then applies the frame rate limit
+    void WaitForFrameSlot();
+    // Marks the point where input was sampled for the frame about to be submitted
+    void BeginFrame();
+    // Call right after the swap
+    void EndFrame();
+
+    void SetMaxFramesInFlight(unsigned int frames);
+    inline unsigned int GetMaxFramesInFlight() const { return m_MaxFramesInFlight; }
+    // 0 or anything below FRAMEPACER_MIN_FPS disables the limiter, vsync still applies
+    void SetTargetFPS(float fps);
+    inline float GetTargetFPS() const { return m_TargetFrameTime > 0.0 ? (float)(1.0 / m_TargetFrameTime) : 0.0f; }
+    inline void SetLateInputSampling(bool late) { m_LateInputSampling = late; }
+    inline bool IsLateInputSampling() const { return m_LateInputSampling; }
+
+    // Latencies in milliseconds of the most recently completed frames, oldest first
+    inline const float* GetLatencyHistory() const { return m_Latency; }
+    inline unsigned int GetLatencyCount() const { return m_LatencyCount; }
+    float GetLastLatency() const;
+    float GetAverageLatency() const;
+    float GetMaxLatency() const;
+    // Milliseconds blocked on fences and the limiter for the last frame
+    inline float GetWaitTime() const { return m_WaitTime; }
+    inline unsigned int GetFramesInFlight() const { return (unsigned int)m_Frames.size(); }
+private:
+    void Retire(const FramePacerFrame& frame);
+    static double Now();
+};
+
+#endif /* FramePacer_h */
@@ -0,0 +1,119 @@
+//
+//  FrameScheduler.cpp
+//  opengl-course
+//
+
+#include "FrameScheduler.h"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include "GLTrace.h"
+#include "imgui/imgui.h"
+
+FrameScheduler::FrameScheduler(GLFWwindow* window, bool onDemand /*= true*/)
+    : m_Window(window), m_OnDemand(onDemand), m_Animating(false), m_PendingFrames(0), m_IdleTimeout(0.5),
+      m_StatsStart(glfwGetTime()), m_StatsCPUStart(std::clock()), m_StatsGLCallStart(GLTrace::GetCallCount()),
+      m_FrameCount(0), m_WakeupCount(0),
+      m_FramesPerSecond(0.0f), m_WakeupsPerSecond(0.0f), m_CPUPerSecond(0.0f), m_GLCallsPerSecond(0.0f)
+{
+    Invalidate();
+
+    glfwSetWindowUserPointer(window, this);
+    glfwSetCursorPosCallback(window, CursorPosCallback);
+    glfwSetMouseButtonCallback(window, MouseButtonCallback);
+    glfwSetScrollCallback(window, ScrollCallback);
+    glfwSetKeyCallback(window, KeyCallback);
+    glfwSetCharCallback(window, CharCallback);
+    glfwSetFramebufferSizeCallback(window, FramebufferSizeCallback);
+    glfwSetWindowRefreshCallback(window, WindowRefreshCallback);
+}
+
+bool FrameScheduler::WaitForFrame() {
+    m_WakeupCount++;
+    if (!m_OnDemand || m_Animating || m_PendingFrames > 0) {
+        glfwPollEvents();
+    } else {
+        // The timeout only bounds how stale the statistics can get
+        glfwWaitEventsTimeout(m_IdleTimeout);
+    }
+    UpdateStats();
+
+    return !m_OnDemand || m_Animating || m_PendingFrames > 0;
+}
+
+void FrameScheduler::EndFrame() {
+    m_FrameCount++;
+    if (m_PendingFrames > 0) {
+        m_PendingFrames--;
+    }
+}
+
+void FrameScheduler::UpdateStats() {
+    double now = glfwGetTime();
+    double elapsed = now - m_StatsStart;
+    if (elapsed < 1.0) {
+        return;
+    }
+
+    std::clock_t cpu = std::clock();
+    unsigned int glCalls = GLTrace::GetCallCount();
+    m_FramesPerSecond = (float)(m_FrameCount / elapsed);
+    m_WakeupsPerSecond = (float)(m_WakeupCount / elapsed);
+    m_CPUPerSecond = (float)((cpu - m_StatsCPUStart) * 1000.0 / CLOCKS_PER_SEC / elapsed);
+    m_GLCallsPerSecond = (float)((glCalls - m_StatsGLCallStart) / elapsed);
+
+    m_StatsStart = now;
+    m_StatsCPUStart = cpu;
+    m_StatsGLCallStart = glCalls;
+    m_FrameCount = 0;
+    m_WakeupCount = 0;
+}
+
+void FrameScheduler::OnImGuiRender() {
+    ImGui::Begin("Frame");
+    bool onDemand = m_OnDemand;
+    if (ImGui::Checkbox("Render on demand", &onDemand)) {
+        SetOnDemand(onDemand);
+    }
+    ImGui::Text("Frames/s:   %.1f", m_FramesPerSecond);
+    ImGui::Text("Wakeups/s:  %.1f", m_WakeupsPerSecond);
+    ImGui::Text("CPU ms/s:   %.1f", m_CPUPerSecond);
+    ImGui::Text("GL calls/s: %.0f", m_GLCallsPerSecond);
+    ImGui::End();
+}
+
+void FrameScheduler::OnInput(GLFWwindow* window) {
+    FrameScheduler* scheduler = (FrameScheduler*)glfwGetWindowUserPointer(window);
+    if (scheduler) {
+        scheduler->Invalidate();
+    }
+}
+
+void FrameScheduler::CursorPosCallback(GLFWwindow* window, double x, double y) {
+    OnInput(window);
+}
+
+void FrameScheduler::MouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    OnInput(window);
+}
+
+void FrameScheduler::ScrollCallback(GLFWwindow* window, double x, double y) {
+    OnInput(window);
+}
+
+void FrameScheduler::KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    OnInput(window);
+}
+
+void FrameScheduler::CharCallback(GLFWwindow* window, unsigned int c) {
+    OnInput(window);
+}
+
+void FrameScheduler::FramebufferSizeCallback(GLFWwindow* window, int width, int height) {
+    OnInput(window);
+}
+
+void FrameScheduler::WindowRefreshCallback(GLFWwindow* window) {
+    OnInput(window);
+}
@@ -0,0 +1,59 @@
+//
+//  FrameScheduler.h
+//  opengl-course
+//
+
+#ifndef FrameScheduler_h
+#define FrameScheduler_h
+
+#include <ctime>
+
+struct GLFWwindow;
+
+class FrameScheduler {
+private:
+    GLFWwindow* m_Window;
+    bool m_OnDemand;
+    bool m_Animating;
+    unsigned int m_PendingFrames;
+    double m_IdleTimeout;
+
+    // Rates measured over the last second of wall-clock time
+    double m_StatsStart;
+    std::clock_t m_StatsCPUStart;
+    unsigned int m_StatsGLCallStart;
+    unsigned int m_FrameCount, m_WakeupCount;
+    float m_FramesPerSecond, m_WakeupsPerSecond, m_CPUPerSecond, m_GLCallsPerSecond;
+public:
+    // Installs the input callbacks, so create it before ImGui_ImplGlfw_InitForOpenGL
+    // which chains to them
+    FrameScheduler(GLFWwindow* window, bool onDemand = true);
+
+    // Blocks until there is something to draw when rendering on demand. Returns
+    // whether this iteration should render a frame.
+    bool WaitForFrame();
+    void EndFrame();
+
+    // Requests redraws, a few frames by default so ImGui can settle after input
+    inline void Invalidate(unsigned int frames = 3) { if (m_PendingFrames < frames) m_PendingFrames = frames; }
+    // Keeps rendering every vsync while something is animating
+    inline void SetAnimating(bool animating) { m_Animating = animating; }
+
+    inline void SetOnDemand(bool onDemand) { m_OnDemand = onDemand; Invalidate(); }
+    inline bool IsOnDemand() const { return m_OnDemand; }
+
+    void OnImGuiRender();
+private:
+    void UpdateStats();
+
+    static void OnInput(GLFWwindow* window);
+    static void CursorPosCallback(GLFWwindow* window, double x, double y);
+    static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void ScrollCallback(GLFWwindow* window, double x, double y);
+    static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void CharCallback(GLFWwindow* window, unsigned int c);
+    static void FramebufferSizeCallback(GLFWwindow* window, int width, int height);
+    static void WindowRefreshCallback(GLFWwindow* window);
+};
+
+#endif /* FrameScheduler_h */
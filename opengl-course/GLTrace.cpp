@@ -0,0 +1,514 @@
+//
+//  GLTrace.cpp
+//  opengl-course
+//
+
+#include "GLTrace.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+bool GLTrace::s_Recording = false;
+const char* GLTrace::s_CallExpression[s_MaxCallDepth];
+const char* GLTrace::s_CallFile[s_MaxCallDepth];
+int GLTrace::s_CallLine[s_MaxCallDepth];
+int GLTrace::s_CallDepth = 0;
+unsigned int GLTrace::s_CallCount = 0;
+
+std::string GLTrace::s_FilePath;
+unsigned int GLTrace::s_FramesLeft = 0;
+GLTraceHeader GLTrace::s_Header;
+std::vector<unsigned char> GLTrace::s_Buffer;
+std::unordered_map<std::string, unsigned short> GLTrace::s_Sites;
+
+void GLTrace::BeginCapture(const std::string& filePath, unsigned int frameCount, int width, int height) {
+    s_FilePath = filePath;
+    s_FramesLeft = frameCount;
+    s_Header = { GLTRACE_MAGIC, GLTRACE_VERSION, 0, width, height };
+    s_Buffer.clear();
+    s_Sites.clear();
+    s_Recording = frameCount > 0;
+}
+
+void GLTrace::EndFrame() {
+    if (!s_Recording) {
+        return;
+    }
+
+    WriteCommand(GLTraceOp::EndFrame);
+    s_Header.FrameCount++;
+    if (--s_FramesLeft == 0) {
+        EndCapture();
+    }
+}
+
+bool GLTrace::EndCapture() {
+    if (!s_Recording) {
+        return false;
+    }
+    s_Recording = false;
+
+    std::ofstream stream(s_FilePath, std::ios::binary);
+    if (!stream) {
+        std::cout << "Failed to open trace file '" << s_FilePath << "'!" << std::endl;
+        return false;
+    }
+    stream.write((const char*)&s_Header, sizeof(s_Header));
+    stream.write((const char*)s_Buffer.data(), s_Buffer.size());
+
+    std::cout << "Captured " << s_Header.FrameCount << " frames (" << s_Buffer.size() <<
+    " bytes) to " << s_FilePath << std::endl;
+    s_Buffer.clear();
+    s_Buffer.shrink_to_fit();
+    return true;
+}
+
+const char* GLTrace::GetOpName(GLTraceOp op) {
+    static const char* names[] = {
+        "DefineSite", "EndFrame",
+        "glClear", "glEnable", "glBlendFunc", "glDrawElements",
+        "glGenBuffers", "glDeleteBuffers", "glBindBuffer", "glBufferData",
+        "glGenVertexArrays", "glDeleteVertexArrays", "glBindVertexArray", "glEnableVertexAttribArray", "glVertexAttribPointer",
+        "glCreateShader", "glShaderSource", "glCompileShader", "glDeleteShader",
+        "glCreateProgram", "glAttachShader", "glLinkProgram", "glValidateProgram", "glUseProgram", "glDeleteProgram",
+        "glGetUniformLocation", "glUniform1i", "glUniform4f", "glUniformMatrix4fv",
+        "glGenTextures", "glDeleteTextures", "glBindTexture", "glActiveTexture", "glTexParameteri", "glTexImage2D",
+        "glDisable", "glViewport", "glGenFramebuffers", "glDeleteFramebuffers", "glBindFramebuffer", "glFramebufferTexture2D"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == (size_t)GLTraceOp::Count, "Missing GLTraceOp name");
+
+    if (op >= GLTraceOp::Count) {
+        return "Unknown";
+    }
+    return names[(int)op];
+}
+
+size_t GLTrace::GetImageSize(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+    size_t components = 4;
+    switch (format) {
+        case GL_RED:
+        case GL_DEPTH_COMPONENT:    components = 1; break;
+        case GL_RG:                 components = 2; break;
+        case GL_RGB:
+        case GL_BGR:                components = 3; break;
+    }
+
+    size_t typeSize = 1;
+    switch (type) {
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:              typeSize = 2; break;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT:              typeSize = 4; break;
+    }
+
+    // Rows are padded to the default GL_UNPACK_ALIGNMENT of 4
+    size_t row = (width * components * typeSize + 3) & ~(size_t)3;
+    return row * height;
+}
+
+void GLTrace::WriteCommand(GLTraceOp op) {
+    unsigned short site = GetSite();
+    Write(op);
+    Write(site);
+}
+
+unsigned short GLTrace::GetSite() {
+    if (s_CallDepth <= 0 || s_CallDepth > s_MaxCallDepth) {
+        return GLTRACE_NO_SITE;
+    }
+    const char* expression = s_CallExpression[s_CallDepth - 1];
+    const char* file = s_CallFile[s_CallDepth - 1];
+    int line = s_CallLine[s_CallDepth - 1];
+
+    std::string key = std::string(file) + ":" + std::to_string(line);
+    auto it = s_Sites.find(key);
+    if (it != s_Sites.end()) {
+        return it->second;
+    }
+
+    if (s_Sites.size() >= GLTRACE_NO_SITE) {
+        return GLTRACE_NO_SITE;
+    }
+    unsigned short site = (unsigned short)s_Sites.size();
+    s_Sites[key] = site;
+
+    Write(GLTraceOp::DefineSite);
+    Write(site);
+    Write(line);
+    WriteBlob(file, strlen(file));
+    WriteBlob(expression, strlen(expression));
+    return site;
+}
+
+void GLTrace::WriteBlob(const void* data, size_t size) {
+    Write((unsigned int)size);
+    if (data && size > 0) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        s_Buffer.insert(s_Buffer.end(), bytes, bytes + size);
+    }
+}
+
+void GLTrace::Clear(GLbitfield mask) {
+    glClear(mask);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::Clear);
+        Write(mask);
+    }
+}
+
+void GLTrace::Enable(GLenum cap) {
+    glEnable(cap);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::Enable);
+        Write(cap);
+    }
+}
+
+void GLTrace::BlendFunc(GLenum sfactor, GLenum dfactor) {
+    glBlendFunc(sfactor, dfactor);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::BlendFunc);
+        Write(sfactor);
+        Write(dfactor);
+    }
+}
+
+void GLTrace::DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+    glDrawElements(mode, count, type, indices);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::DrawElements);
+        Write(mode);
+        Write(count);
+        Write(type);
+        Write((unsigned long long)(size_t)indices);
+    }
+}
+
+void GLTrace::GenBuffers(GLsizei n, GLuint* buffers) {
+    glGenBuffers(n, buffers);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::GenBuffers);
+        WriteBlob(buffers, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::DeleteBuffers(GLsizei n, const GLuint* buffers) {
+    glDeleteBuffers(n, buffers);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::DeleteBuffers);
+        WriteBlob(buffers, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::BindBuffer(GLenum target, GLuint buffer) {
+    glBindBuffer(target, buffer);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::BindBuffer);
+        Write(target);
+        Write(buffer);
+    }
+}
+
+void GLTrace::BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    glBufferData(target, size, data, usage);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::BufferData);
+        Write(target);
+        Write((long long)size);
+        WriteBlob(data, data ? size : 0);
+        Write(usage);
+    }
+}
+
+void GLTrace::GenVertexArrays(GLsizei n, GLuint* arrays) {
+    glGenVertexArrays(n, arrays);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::GenVertexArrays);
+        WriteBlob(arrays, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::DeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+    glDeleteVertexArrays(n, arrays);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::DeleteVertexArrays);
+        WriteBlob(arrays, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::BindVertexArray(GLuint array) {
+    glBindVertexArray(array);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::BindVertexArray);
+        Write(array);
+    }
+}
+
+void GLTrace::EnableVertexAttribArray(GLuint index) {
+    glEnableVertexAttribArray(index);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::EnableVertexAttribArray);
+        Write(index);
+    }
+}
+
+void GLTrace::VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) {
+    glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::VertexAttribPointer);
+        Write(index);
+        Write(size);
+        Write(type);
+        Write(normalized);
+        Write(stride);
+        Write((unsigned long long)(size_t)pointer);
+    }
+}
+
+GLuint GLTrace::CreateShader(GLenum type) {
+    GLuint shader = glCreateShader(type);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::CreateShader);
+        Write(type);
+        Write(shader);
+    }
+    return shader;
+}
+
+void GLTrace::ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+    glShaderSource(shader, count, string, length);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::ShaderSource);
+        Write(shader);
+        Write(count);
+        for (GLsizei i = 0; i < count; i++) {
+            size_t size = (length && length[i] >= 0) ? length[i] : strlen(string[i]);
+            WriteBlob(string[i], size);
+        }
+    }
+}
+
+void GLTrace::CompileShader(GLuint shader) {
+    glCompileShader(shader);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::CompileShader);
+        Write(shader);
+    }
+}
+
+void GLTrace::DeleteShader(GLuint shader) {
+    glDeleteShader(shader);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::DeleteShader);
+        Write(shader);
+    }
+}
+
+GLuint GLTrace::CreateProgram() {
+    GLuint program = glCreateProgram();
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::CreateProgram);
+        Write(program);
+    }
+    return program;
+}
+
+void GLTrace::AttachShader(GLuint program, GLuint shader) {
+    glAttachShader(program, shader);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::AttachShader);
+        Write(program);
+        Write(shader);
+    }
+}
+
+void GLTrace::LinkProgram(GLuint program) {
+    glLinkProgram(program);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::LinkProgram);
+        Write(program);
+    }
+}
+
+void GLTrace::ValidateProgram(GLuint program) {
+    glValidateProgram(program);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::ValidateProgram);
+        Write(program);
+    }
+}
+
+void GLTrace::UseProgram(GLuint program) {
+    glUseProgram(program);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::UseProgram);
+        Write(program);
+    }
+}
+
+void GLTrace::DeleteProgram(GLuint program) {
+    glDeleteProgram(program);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::DeleteProgram);
+        Write(program);
+    }
+}
+
+GLint GLTrace::GetUniformLocation(GLuint program, const GLchar* name) {
+    GLint location = glGetUniformLocation(program, name);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::GetUniformLocation);
+        Write(program);
+        WriteBlob(name, strlen(name));
+        Write(location);
+    }
+    return location;
+}
+
+void GLTrace::Uniform1i(GLint location, GLint v0) {
+    glUniform1i(location, v0);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::Uniform1i);
+        Write(location);
+        Write(v0);
+    }
+}
+
+void GLTrace::Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+    glUniform4f(location, v0, v1, v2, v3);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::Uniform4f);
+        Write(location);
+        Write(v0);
+        Write(v1);
+        Write(v2);
+        Write(v3);
+    }
+}
+
+void GLTrace::UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    glUniformMatrix4fv(location, count, transpose, value);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::UniformMatrix4fv);
+        Write(location);
+        Write(transpose);
+        WriteBlob(value, count * 16 * sizeof(GLfloat));
+    }
+}
+
+void GLTrace::GenTextures(GLsizei n, GLuint* textures) {
+    glGenTextures(n, textures);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::GenTextures);
+        WriteBlob(textures, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::DeleteTextures(GLsizei n, const GLuint* textures) {
+    glDeleteTextures(n, textures);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::DeleteTextures);
+        WriteBlob(textures, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::BindTexture(GLenum target, GLuint texture) {
+    glBindTexture(target, texture);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::BindTexture);
+        Write(target);
+        Write(texture);
+    }
+}
+
+void GLTrace::ActiveTexture(GLenum texture) {
+    glActiveTexture(texture);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::ActiveTexture);
+        Write(texture);
+    }
+}
+
+void GLTrace::TexParameteri(GLenum target, GLenum pname, GLint param) {
+    glTexParameteri(target, pname, param);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::TexParameteri);
+        Write(target);
+        Write(pname);
+        Write(param);
+    }
+}
+
+void GLTrace::TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+    glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::TexImage2D);
+        Write(target);
+        Write(level);
+        Write(internalformat);
+        Write(width);
+        Write(height);
+        Write(border);
+        Write(format);
+        Write(type);
+        WriteBlob(pixels, pixels ? GetImageSize(width, height, format, type) : 0);
+    }
+}
+
+void GLTrace::Disable(GLenum cap) {
+    glDisable(cap);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::Disable);
+        Write(cap);
+    }
+}
+
+void GLTrace::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    glViewport(x, y, width, height);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::Viewport);
+        Write(x);
+        Write(y);
+        Write(width);
+        Write(height);
+    }
+}
+
+void GLTrace::GenFramebuffers(GLsizei n, GLuint* framebuffers) {
+    glGenFramebuffers(n, framebuffers);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::GenFramebuffers);
+        WriteBlob(framebuffers, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+    glDeleteFramebuffers(n, framebuffers);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::DeleteFramebuffers);
+        WriteBlob(framebuffers, n * sizeof(GLuint));
+    }
+}
+
+void GLTrace::BindFramebuffer(GLenum target, GLuint framebuffer) {
+    glBindFramebuffer(target, framebuffer);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::BindFramebuffer);
+        Write(target);
+        Write(framebuffer);
+    }
+}
+
+void GLTrace::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+    glFramebufferTexture2D(target, attachment, textarget, texture, level);
+    if (s_Recording) {
+        WriteCommand(GLTraceOp::FramebufferTexture2D);
+        Write(target);
+        Write(attachment);
+        Write(textarget);
+        Write(texture);
+        Write(level);
+    }
+}
@@ -0,0 +1,135 @@
+//
+//  GLTrace.h
+//  opengl-course
+//
+
+#ifndef GLTrace_h
+#define GLTrace_h
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Trace file layout: a GLTraceHeader followed by a stream of commands. Every
+// command starts with its GLTraceOp (1 byte) and call site id (2 bytes), the
+// arguments follow in call order. Pointers to client memory are stored as a
+// 4 byte size followed by the payload bytes.
+#define GLTRACE_MAGIC 0x52544C47 // "GLTR"
+#define GLTRACE_VERSION 2
+#define GLTRACE_NO_SITE 0xFFFF
+
+struct GLTraceHeader {
+    unsigned int Magic;
+    unsigned int Version;
+    unsigned int FrameCount;
+    int Width, Height;
+};
+
+enum class GLTraceOp : unsigned char {
+    DefineSite = 0, EndFrame,
+    Clear, Enable, BlendFunc, DrawElements,
+    GenBuffers, DeleteBuffers, BindBuffer, BufferData,
+    GenVertexArrays, DeleteVertexArrays, BindVertexArray, EnableVertexAttribArray, VertexAttribPointer,
+    CreateShader, ShaderSource, CompileShader, DeleteShader,
+    CreateProgram, AttachShader, LinkProgram, ValidateProgram, UseProgram, DeleteProgram,
+    GetUniformLocation, Uniform1i, Uniform4f, UniformMatrix4fv,
+    GenTextures, DeleteTextures, BindTexture, ActiveTexture, TexParameteri, TexImage2D,
+    Disable, Viewport, GenFramebuffers, DeleteFramebuffers, BindFramebuffer, FramebufferTexture2D,
+    Count
+};
+
+class GLTrace {
+private:
+    static bool s_Recording;
+    static const int s_MaxCallDepth = 8;
+    static const char* s_CallExpression[s_MaxCallDepth];
+    static const char* s_CallFile[s_MaxCallDepth];
+    static int s_CallLine[s_MaxCallDepth];
+    static int s_CallDepth;
+    static unsigned int s_CallCount;
+
+    static std::string s_FilePath;
+    static unsigned int s_FramesLeft;
+    static GLTraceHeader s_Header;
+    static std::vector<unsigned char> s_Buffer;
+    static std::unordered_map<std::string, unsigned short> s_Sites;
+public:
+    // Records every hooked call from now on and writes the trace after frameCount frames
+    static void BeginCapture(const std::string& filePath, unsigned int frameCount, int width, int height);
+    static void EndFrame();
+    static bool EndCapture();
+    static inline bool IsRecording() { return s_Recording; }
+
+    // Set by GLCall so the recorded commands carry the expression, file and line.
+    // Calls nest, e.g. GetUniformLocation() inside GLCall(glUniform1i(...)).
+    static inline void BeginCall(const char* expression, const char* file, int line) {
+        if (s_CallDepth < s_MaxCallDepth) {
+            s_CallExpression[s_CallDepth] = expression;
+            s_CallFile[s_CallDepth] = file;
+            s_CallLine[s_CallDepth] = line;
+        }
+        s_CallDepth++;
+        s_CallCount++;
+    }
+    static inline void EndCall() { s_CallDepth--; }
+    // Number of GLCall invocations so far, recording or not
+    static inline unsigned int GetCallCount() { return s_CallCount; }
+
+    static const char* GetOpName(GLTraceOp op);
+    static size_t GetImageSize(GLsizei width, GLsizei height, GLenum format, GLenum type);
+
+    // Hooked entry points, see GLTraceHooks.h
+    static void Clear(GLbitfield mask);
+    static void Enable(GLenum cap);
+    static void BlendFunc(GLenum sfactor, GLenum dfactor);
+    static void DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+    static void GenBuffers(GLsizei n, GLuint* buffers);
+    static void DeleteBuffers(GLsizei n, const GLuint* buffers);
+    static void BindBuffer(GLenum target, GLuint buffer);
+    static void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    static void GenVertexArrays(GLsizei n, GLuint* arrays);
+    static void DeleteVertexArrays(GLsizei n, const GLuint* arrays);
+    static void BindVertexArray(GLuint array);
+    static void EnableVertexAttribArray(GLuint index);
+    static void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+    static GLuint CreateShader(GLenum type);
+    static void ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+    static void CompileShader(GLuint shader);
+    static void DeleteShader(GLuint shader);
+    static GLuint CreateProgram();
+    static void AttachShader(GLuint program, GLuint shader);
+    static void LinkProgram(GLuint program);
+    static void ValidateProgram(GLuint program);
+    static void UseProgram(GLuint program);
+    static void DeleteProgram(GLuint program);
+    static GLint GetUniformLocation(GLuint program, const GLchar* name);
+    static void Uniform1i(GLint location, GLint v0);
+    static void Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+    static void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+    static void GenTextures(GLsizei n, GLuint* textures);
+    static void DeleteTextures(GLsizei n, const GLuint* textures);
+    static void BindTexture(GLenum target, GLuint texture);
+    static void ActiveTexture(GLenum texture);
+    static void TexParameteri(GLenum target, GLenum pname, GLint param);
+    static void TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels);
+    static void Disable(GLenum cap);
+    static void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    static void GenFramebuffers(GLsizei n, GLuint* framebuffers);
+    static void DeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+    static void BindFramebuffer(GLenum target, GLuint framebuffer);
+    static void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+private:
+    static void WriteCommand(GLTraceOp op);
+    static unsigned short GetSite();
+
+    template<typename T>
+    static void Write(const T& value) {
+        const unsigned char* bytes = (const unsigned char*)&value;
+        s_Buffer.insert(s_Buffer.end(), bytes, bytes + sizeof(T));
+    }
+    static void WriteBlob(const void* data, size_t size);
+};
+
+#endif /* GLTrace_h */
@@ -0,0 +1,94 @@
+//
+//  GLTraceHooks.h
+//  opengl-course
+//
+
+#ifndef GLTraceHooks_h
+#define GLTraceHooks_h
+
+// Routes the GL calls made by the renderer through GLTrace so they can be
+// captured. Include after <GL/glew.h>, never from GLTrace.cpp itself.
+
+#include "GLTrace.h"
+
+#undef glClear
+#undef glEnable
+#undef glBlendFunc
+#undef glDrawElements
+#undef glGenBuffers
+#undef glDeleteBuffers
+#undef glBindBuffer
+#undef glBufferData
+#undef glGenVertexArrays
+#undef glDeleteVertexArrays
+#undef glBindVertexArray
+#undef glEnableVertexAttribArray
+#undef glVertexAttribPointer
+#undef glCreateShader
+#undef glShaderSource
+#undef glCompileShader
+#undef glDeleteShader
+#undef glCreateProgram
+#undef glAttachShader
+#undef glLinkProgram
+#undef glValidateProgram
+#undef glUseProgram
+#undef glDeleteProgram
+#undef glGetUniformLocation
+#undef glUniform1i
+#undef glUniform4f
+#undef glUniformMatrix4fv
+#undef glGenTextures
+#undef glDeleteTextures
+#undef glBindTexture
+#undef glActiveTexture
+#undef glTexParameteri
+#undef glTexImage2D
+#undef glDisable
+#undef glViewport
+#undef glGenFramebuffers
+#undef glDeleteFramebuffers
+#undef glBindFramebuffer
+#undef glFramebufferTexture2D
+
+#define glClear                     GLTrace::Clear
+#define glEnable                    GLTrace::Enable
+#define glBlendFunc                 GLTrace::BlendFunc
+#define glDrawElements              GLTrace::DrawElements
+#define glGenBuffers                GLTrace::GenBuffers
+#define glDeleteBuffers             GLTrace::DeleteBuffers
+#define glBindBuffer                GLTrace::BindBuffer
+#define glBufferData                GLTrace::BufferData
+#define glGenVertexArrays           GLTrace::GenVertexArrays
+#define glDeleteVertexArrays        GLTrace::DeleteVertexArrays
+#define glBindVertexArray           GLTrace::BindVertexArray
+#define glEnableVertexAttribArray   GLTrace::EnableVertexAttribArray
+#define glVertexAttribPointer       GLTrace::VertexAttribPointer
+#define glCreateShader              GLTrace::CreateShader
+#define glShaderSource              GLTrace::ShaderSource
+#define glCompileShader             GLTrace::CompileShader
+#define glDeleteShader              GLTrace::DeleteShader
+#define glCreateProgram             GLTrace::CreateProgram
+#define glAttachShader              GLTrace::AttachShader
+#define glLinkProgram               GLTrace::LinkProgram
+#define glValidateProgram           GLTrace::ValidateProgram
+#define glUseProgram                GLTrace::UseProgram
+#define glDeleteProgram             GLTrace::DeleteProgram
+#define glGetUniformLocation        GLTrace::GetUniformLocation
+#define glUniform1i                 GLTrace::Uniform1i
+#define glUniform4f                 GLTrace::Uniform4f
+#define glUniformMatrix4fv          GLTrace::UniformMatrix4fv
+#define glGenTextures               GLTrace::GenTextures
+#define glDeleteTextures            GLTrace::DeleteTextures
+#define glBindTexture               GLTrace::BindTexture
+#define glActiveTexture             GLTrace::ActiveTexture
+#define glTexParameteri             GLTrace::TexParameteri
+#define glTexImage2D                GLTrace::TexImage2D
+#define glDisable                   GLTrace::Disable
+#define glViewport                  GLTrace::Viewport
+#define glGenFramebuffers           GLTrace::GenFramebuffers
+#define glDeleteFramebuffers        GLTrace::DeleteFramebuffers
+#define glBindFramebuffer           GLTrace::BindFramebuffer
+#define glFramebufferTexture2D      GLTrace::FramebufferTexture2D
+
+#endif /* GLTraceHooks_h */
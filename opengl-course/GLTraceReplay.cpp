@@ -0,0 +1,648 @@
+//
+//  GLTraceReplay.cpp
+//  opengl-course
+//
+
+// Standalone tool that re-executes a trace written by GLTrace on a hidden
+// window and reports per-call and per-frame timings. The hidden window still
+// needs an X11 or Wayland display, so on a machine without one run it under
+// Xvfb, e.g. with Mesa's llvmpipe to compare runs on identical work:
+//
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a gltrace-replay trace.bin
+//
+//   gltrace-replay <trace> [--loops N] [--sync] [--csv file]
+//                          [--frames-in-flight N] [--fps N]
+//
+// With --frames-in-flight or --fps the frames are paced by FramePacer instead
+// of a glFinish per frame, and the input-to-GPU-completion latency is reported.
+
+#define GLEW_STATIC
+#include <GL/glew.h>
+
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include "GLTrace.h"
+#include "FramePacer.h"
+
+struct ReplaySite {
+    int Line;
+    std::string File;
+    std::string Expression;
+};
+
+struct ReplayStats {
+    unsigned long long Count = 0;
+    double Total = 0.0;
+    double Max = 0.0;
+
+    void Add(double time) {
+        Count++;
+        Total += time;
+        Max = std::max(Max, time);
+    }
+};
+
+class TraceReader {
+private:
+    const std::vector<unsigned char>& m_Data;
+    size_t m_Offset;
+public:
+    TraceReader(const std::vector<unsigned char>& data, size_t offset)
+        : m_Data(data), m_Offset(offset) {}
+
+    inline bool IsEnd() const { return m_Offset >= m_Data.size(); }
+
+    template<typename T>
+    T Read() {
+        T value;
+        if (m_Offset + sizeof(T) > m_Data.size()) {
+            throw std::runtime_error("Trace is truncated");
+        }
+        memcpy(&value, &m_Data[m_Offset], sizeof(T));
+        m_Offset += sizeof(T);
+        return value;
+    }
+
+    const void* ReadBlob(unsigned int& size) {
+        size = Read<unsigned int>();
+        if (m_Offset + size > m_Data.size()) {
+            throw std::runtime_error("Trace is truncated");
+        }
+        const void* data = size > 0 ? &m_Data[m_Offset] : nullptr;
+        m_Offset += size;
+        return data;
+    }
+
+    std::string ReadString() {
+        unsigned int size;
+        const char* data = (const char*)ReadBlob(size);
+        return data ? std::string(data, size) : std::string();
+    }
+};
+
+class TraceReplayer {
+private:
+    std::unordered_map<GLuint, GLuint> m_Buffers, m_VertexArrays, m_Textures, m_Shaders, m_Programs, m_Framebuffers;
+    // Keyed by captured program << 32 | captured location
+    std::unordered_map<unsigned long long, GLint> m_Locations;
+    GLuint m_CurrentProgram;
+public:
+    TraceReplayer()
+        : m_CurrentProgram(0) {}
+    ~TraceReplayer();
+
+    void Execute(GLTraceOp op, TraceReader& reader);
+private:
+    static GLuint Map(const std::unordered_map<GLuint, GLuint>& names, GLuint name) {
+        auto it = names.find(name);
+        return it != names.end() ? it->second : name;
+    }
+
+    GLint MapLocation(GLint location) const {
+        auto it = m_Locations.find(((unsigned long long)m_CurrentProgram << 32) | (unsigned int)location);
+        return it != m_Locations.end() ? it->second : location;
+    }
+
+    template<typename GenFunc>
+    static void Generate(std::unordered_map<GLuint, GLuint>& names, TraceReader& reader, GenFunc gen) {
+        unsigned int size;
+        const GLuint* captured = (const GLuint*)reader.ReadBlob(size);
+        GLsizei n = size / sizeof(GLuint);
+        std::vector<GLuint> created(n);
+        gen(n, created.data());
+        for (GLsizei i = 0; i < n; i++) {
+            names[captured[i]] = created[i];
+        }
+    }
+
+    template<typename DeleteFunc>
+    static void Delete(std::unordered_map<GLuint, GLuint>& names, TraceReader& reader, DeleteFunc del) {
+        unsigned int size;
+        const GLuint* captured = (const GLuint*)reader.ReadBlob(size);
+        GLsizei n = size / sizeof(GLuint);
+        std::vector<GLuint> mapped(n);
+        for (GLsizei i = 0; i < n; i++) {
+            mapped[i] = Map(names, captured[i]);
+            names.erase(captured[i]);
+        }
+        del(n, mapped.data());
+    }
+};
+
+// Captures stop before the app's destructors run, so traces never delete what
+// they create. Release it here so every loop starts from the same driver state.
+TraceReplayer::~TraceReplayer() {
+    std::vector<GLuint> names;
+    auto collect = [&names](const std::unordered_map<GLuint, GLuint>& objects) {
+        names.clear();
+        for (const auto& object : objects) {
+            names.push_back(object.second);
+        }
+        return (GLsizei)names.size();
+    };
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindVertexArray(0);
+    glUseProgram(0);
+
+    if (GLsizei n = collect(m_Framebuffers)) {
+        glDeleteFramebuffers(n, names.data());
+    }
+    if (GLsizei n = collect(m_VertexArrays)) {
+        glDeleteVertexArrays(n, names.data());
+    }
+    if (GLsizei n = collect(m_Buffers)) {
+        glDeleteBuffers(n, names.data());
+    }
+    if (GLsizei n = collect(m_Textures)) {
+        glDeleteTextures(n, names.data());
+    }
+    for (const auto& program : m_Programs) {
+        glDeleteProgram(program.second);
+    }
+    for (const auto& shader : m_Shaders) {
+        glDeleteShader(shader.second);
+    }
+    glFinish();
+}
+
+void TraceReplayer::Execute(GLTraceOp op, TraceReader& reader) {
+    switch (op) {
+        case GLTraceOp::Clear: {
+            glClear(reader.Read<GLbitfield>());
+            break;
+        }
+        case GLTraceOp::Enable: {
+            glEnable(reader.Read<GLenum>());
+            break;
+        }
+        case GLTraceOp::BlendFunc: {
+            GLenum sfactor = reader.Read<GLenum>();
+            GLenum dfactor = reader.Read<GLenum>();
+            glBlendFunc(sfactor, dfactor);
+            break;
+        }
+        case GLTraceOp::DrawElements: {
+            GLenum mode = reader.Read<GLenum>();
+            GLsizei count = reader.Read<GLsizei>();
+            GLenum type = reader.Read<GLenum>();
+            size_t offset = (size_t)reader.Read<unsigned long long>();
+            glDrawElements(mode, count, type, (const void*)offset);
+            break;
+        }
+        case GLTraceOp::GenBuffers: {
+            Generate(m_Buffers, reader, [](GLsizei n, GLuint* names) { glGenBuffers(n, names); });
+            break;
+        }
+        case GLTraceOp::DeleteBuffers: {
+            Delete(m_Buffers, reader, [](GLsizei n, const GLuint* names) { glDeleteBuffers(n, names); });
+            break;
+        }
+        case GLTraceOp::BindBuffer: {
+            GLenum target = reader.Read<GLenum>();
+            GLuint buffer = reader.Read<GLuint>();
+            glBindBuffer(target, Map(m_Buffers, buffer));
+            break;
+        }
+        case GLTraceOp::BufferData: {
+            GLenum target = reader.Read<GLenum>();
+            GLsizeiptr size = (GLsizeiptr)reader.Read<long long>();
+            unsigned int dataSize;
+            const void* data = reader.ReadBlob(dataSize);
+            GLenum usage = reader.Read<GLenum>();
+            glBufferData(target, size, data, usage);
+            break;
+        }
+        case GLTraceOp::GenVertexArrays: {
+            Generate(m_VertexArrays, reader, [](GLsizei n, GLuint* names) { glGenVertexArrays(n, names); });
+            break;
+        }
+        case GLTraceOp::DeleteVertexArrays: {
+            Delete(m_VertexArrays, reader, [](GLsizei n, const GLuint* names) { glDeleteVertexArrays(n, names); });
+            break;
+        }
+        case GLTraceOp::BindVertexArray: {
+            glBindVertexArray(Map(m_VertexArrays, reader.Read<GLuint>()));
+            break;
+        }
+        case GLTraceOp::EnableVertexAttribArray: {
+            glEnableVertexAttribArray(reader.Read<GLuint>());
+            break;
+        }
+        case GLTraceOp::VertexAttribPointer: {
+            GLuint index = reader.Read<GLuint>();
+            GLint size = reader.Read<GLint>();
+            GLenum type = reader.Read<GLenum>();
+            GLboolean normalized = reader.Read<GLboolean>();
+            GLsizei stride = reader.Read<GLsizei>();
+            size_t offset = (size_t)reader.Read<unsigned long long>();
+            glVertexAttribPointer(index, size, type, normalized, stride, (const void*)offset);
+            break;
+        }
+        case GLTraceOp::CreateShader: {
+            GLenum type = reader.Read<GLenum>();
+            GLuint shader = reader.Read<GLuint>();
+            m_Shaders[shader] = glCreateShader(type);
+            break;
+        }
+        case GLTraceOp::ShaderSource: {
+            GLuint shader = reader.Read<GLuint>();
+            GLsizei count = reader.Read<GLsizei>();
+            std::vector<const GLchar*> strings(count);
+            std::vector<GLint> lengths(count);
+            for (GLsizei i = 0; i < count; i++) {
+                unsigned int size;
+                strings[i] = (const GLchar*)reader.ReadBlob(size);
+                lengths[i] = size;
+                if (!strings[i]) {
+                    strings[i] = "";
+                }
+            }
+            glShaderSource(Map(m_Shaders, shader), count, strings.data(), lengths.data());
+            break;
+        }
+        case GLTraceOp::CompileShader: {
+            glCompileShader(Map(m_Shaders, reader.Read<GLuint>()));
+            break;
+        }
+        case GLTraceOp::DeleteShader: {
+            GLuint shader = reader.Read<GLuint>();
+            glDeleteShader(Map(m_Shaders, shader));
+            m_Shaders.erase(shader);
+            break;
+        }
+        case GLTraceOp::CreateProgram: {
+            GLuint program = reader.Read<GLuint>();
+            m_Programs[program] = glCreateProgram();
+            break;
+        }
+        case GLTraceOp::AttachShader: {
+            GLuint program = reader.Read<GLuint>();
+            GLuint shader = reader.Read<GLuint>();
+            glAttachShader(Map(m_Programs, program), Map(m_Shaders, shader));
+            break;
+        }
+        case GLTraceOp::LinkProgram: {
+            glLinkProgram(Map(m_Programs, reader.Read<GLuint>()));
+            break;
+        }
+        case GLTraceOp::ValidateProgram: {
+            glValidateProgram(Map(m_Programs, reader.Read<GLuint>()));
+            break;
+        }
+        case GLTraceOp::UseProgram: {
+            m_CurrentProgram = reader.Read<GLuint>();
+            glUseProgram(Map(m_Programs, m_CurrentProgram));
+            break;
+        }
+        case GLTraceOp::DeleteProgram: {
+            GLuint program = reader.Read<GLuint>();
+            glDeleteProgram(Map(m_Programs, program));
+            m_Programs.erase(program);
+            break;
+        }
+        case GLTraceOp::GetUniformLocation: {
+            GLuint program = reader.Read<GLuint>();
+            std::string name = reader.ReadString();
+            GLint location = reader.Read<GLint>();
+            m_Locations[((unsigned long long)program << 32) | (unsigned int)location] =
+                glGetUniformLocation(Map(m_Programs, program), name.c_str());
+            break;
+        }
+        case GLTraceOp::Uniform1i: {
+            GLint location = reader.Read<GLint>();
+            GLint v0 = reader.Read<GLint>();
+            glUniform1i(MapLocation(location), v0);
+            break;
+        }
+        case GLTraceOp::Uniform4f: {
+            GLint location = reader.Read<GLint>();
+            GLfloat v[4];
+            for (int i = 0; i < 4; i++) {
+                v[i] = reader.Read<GLfloat>();
+            }
+            glUniform4f(MapLocation(location), v[0], v[1], v[2], v[3]);
+            break;
+        }
+        case GLTraceOp::UniformMatrix4fv: {
+            GLint location = reader.Read<GLint>();
+            GLboolean transpose = reader.Read<GLboolean>();
+            unsigned int size;
+            const GLfloat* value = (const GLfloat*)reader.ReadBlob(size);
+            glUniformMatrix4fv(MapLocation(location), size / (16 * sizeof(GLfloat)), transpose, value);
+            break;
+        }
+        case GLTraceOp::GenTextures: {
+            Generate(m_Textures, reader, [](GLsizei n, GLuint* names) { glGenTextures(n, names); });
+            break;
+        }
+        case GLTraceOp::DeleteTextures: {
+            Delete(m_Textures, reader, [](GLsizei n, const GLuint* names) { glDeleteTextures(n, names); });
+            break;
+        }
+        case GLTraceOp::BindTexture: {
+            GLenum target = reader.Read<GLenum>();
+            GLuint texture = reader.Read<GLuint>();
+            glBindTexture(target, Map(m_Textures, texture));
+            break;
+        }
+        case GLTraceOp::ActiveTexture: {
+            glActiveTexture(reader.Read<GLenum>());
+            break;
+        }
+        case GLTraceOp::TexParameteri: {
+            GLenum target = reader.Read<GLenum>();
+            GLenum pname = reader.Read<GLenum>();
+            GLint param = reader.Read<GLint>();
+            glTexParameteri(target, pname, param);
+            break;
+        }
+        case GLTraceOp::TexImage2D: {
+            GLenum target = reader.Read<GLenum>();
+            GLint level = reader.Read<GLint>();
+            GLint internalformat = reader.Read<GLint>();
+            GLsizei width = reader.Read<GLsizei>();
+            GLsizei height = reader.Read<GLsizei>();
+            GLint border = reader.Read<GLint>();
+            GLenum format = reader.Read<GLenum>();
+            GLenum type = reader.Read<GLenum>();
+            unsigned int size;
+            const void* pixels = reader.ReadBlob(size);
+            glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+            break;
+        }
+        case GLTraceOp::Disable: {
+            glDisable(reader.Read<GLenum>());
+            break;
+        }
+        case GLTraceOp::Viewport: {
+            GLint x = reader.Read<GLint>();
+            GLint y = reader.Read<GLint>();
+            GLsizei width = reader.Read<GLsizei>();
+            GLsizei height = reader.Read<GLsizei>();
+            glViewport(x, y, width, height);
+            break;
+        }
+        case GLTraceOp::GenFramebuffers: {
+            Generate(m_Framebuffers, reader, [](GLsizei n, GLuint* names) { glGenFramebuffers(n, names); });
+            break;
+        }
+        case GLTraceOp::DeleteFramebuffers: {
+            Delete(m_Framebuffers, reader, [](GLsizei n, const GLuint* names) { glDeleteFramebuffers(n, names); });
+            break;
+        }
+        case GLTraceOp::BindFramebuffer: {
+            GLenum target = reader.Read<GLenum>();
+            GLuint framebuffer = reader.Read<GLuint>();
+            glBindFramebuffer(target, Map(m_Framebuffers, framebuffer));
+            break;
+        }
+        case GLTraceOp::FramebufferTexture2D: {
+            GLenum target = reader.Read<GLenum>();
+            GLenum attachment = reader.Read<GLenum>();
+            GLenum textarget = reader.Read<GLenum>();
+            GLuint texture = reader.Read<GLuint>();
+            GLint level = reader.Read<GLint>();
+            glFramebufferTexture2D(target, attachment, textarget, Map(m_Textures, texture), level);
+            break;
+        }
+        default:
+            throw std::runtime_error("Unknown trace command " + std::to_string((int)op));
+    }
+}
+
+static void GLFWErrorCallback(int error, const char* description) {
+    std::cout << "[GLFW Error] (" << error << "): " << description << std::endl;
+}
+
+static bool LoadTrace(const std::string& filePath, GLTraceHeader& header, std::vector<unsigned char>& data) {
+    std::ifstream stream(filePath, std::ios::binary);
+    if (!stream) {
+        std::cout << "Failed to open trace '" << filePath << "'!" << std::endl;
+        return false;
+    }
+
+    data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(GLTraceHeader)) {
+        std::cout << "Trace '" << filePath << "' is too small!" << std::endl;
+        return false;
+    }
+
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.Magic != GLTRACE_MAGIC || header.Version != GLTRACE_VERSION) {
+        std::cout << "Trace '" << filePath << "' has an unsupported format!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <trace> [--loops N] [--sync] [--csv file]" <<
+        " [--frames-in-flight N] [--fps N]" << std::endl;
+        return -1;
+    }
+
+    std::string tracePath = argv[1];
+    unsigned int loops = 1;
+    bool sync = false;
+    std::string csvPath;
+    unsigned int framesInFlight = 0;
+    float fps = 0.0f;
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "--loops") && i + 1 < argc) {
+            loops = std::max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--sync")) {
+            sync = true;
+        } else if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else if (!strcmp(argv[i], "--frames-in-flight") && i + 1 < argc) {
+            framesInFlight = (unsigned int)atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--fps") && i + 1 < argc) {
+            fps = (float)atof(argv[++i]);
+        }
+    }
+
+    GLTraceHeader header;
+    std::vector<unsigned char> data;
+    if (!LoadTrace(tracePath, header, data)) {
+        return -1;
+    }
+
+    glfwSetErrorCallback(GLFWErrorCallback);
+    if (!glfwInit()) {
+        std::cout << "Failed to initialize GLFW, is a display available? Try xvfb-run." << std::endl;
+        return -1;
+    }
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+    glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(header.Width, header.Height, "Trace Replay", NULL, NULL);
+    if (!window) {
+        std::cout << "Failed to create a " << header.Width << "x" << header.Height <<
+        " OpenGL 3.3 core window!" << std::endl;
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::cout << "Error! glew it not ok" << std::endl;
+    }
+
+    std::cout << "GL Version " << glGetString(GL_VERSION) << std::endl;
+    std::cout << "GL Renderer " << glGetString(GL_RENDERER) << std::endl;
+
+    bool pacing = framesInFlight > 0 || fps > 0.0f;
+    // Owns fences and queries, so it is released before the context goes away
+    std::unique_ptr<FramePacer> pacer(new FramePacer(framesInFlight > 0 ? framesInFlight : FRAMEPACER_MAX_FRAMES_IN_FLIGHT, fps));
+    
+    std::ofstream csv;
+    if (!csvPath.empty()) {
+        csv.open(csvPath);
+        csv << "loop,frame,call,op,site,microseconds" << std::endl;
+    }
+
+    typedef std::chrono::high_resolution_clock Clock;
+    std::unordered_map<unsigned short, ReplaySite> sites;
+    ReplayStats opStats[(int)GLTraceOp::Count];
+    std::unordered_map<unsigned short, ReplayStats> siteStats;
+    std::vector<double> frameTimes;
+
+    try {
+        for (unsigned int loop = 0; loop < loops; loop++) {
+            // Every loop starts from a fresh set of objects, like the captured run did
+            TraceReplayer replayer;
+            TraceReader reader(data, sizeof(GLTraceHeader));
+            unsigned int frame = 0;
+            unsigned long long call = 0;
+            bool frameStarted = false;
+            auto frameStart = Clock::now();
+
+            while (!reader.IsEnd()) {
+                GLTraceOp op = reader.Read<GLTraceOp>();
+                unsigned short site = reader.Read<unsigned short>();
+
+                if (op == GLTraceOp::DefineSite) {
+                    ReplaySite& definition = sites[site];
+                    definition.Line = reader.Read<int>();
+                    definition.File = reader.ReadString();
+                    definition.Expression = reader.ReadString();
+                    continue;
+                }
+
+                if (pacing && !frameStarted) {
+                    pacer->WaitForFrameSlot();
+                    pacer->BeginFrame();
+                }
+                frameStarted = true;
+
+                if (op == GLTraceOp::EndFrame) {
+                    glfwSwapBuffers(window);
+                    if (pacing) {
+                        pacer->EndFrame();
+                    } else {
+                        glFinish();
+                    }
+                    frameStarted = false;
+                    auto frameEnd = Clock::now();
+                    frameTimes.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+                    frameStart = frameEnd;
+                    frame++;
+                    glfwPollEvents();
+                    continue;
+                }
+
+                auto start = Clock::now();
+                replayer.Execute(op, reader);
+                if (sync) {
+                    glFinish();
+                }
+                double time = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+                opStats[(int)op].Add(time);
+                if (site != GLTRACE_NO_SITE) {
+                    siteStats[site].Add(time);
+                }
+                if (csv.is_open()) {
+                    csv << loop << "," << frame << "," << call << "," << GLTrace::GetOpName(op) << "," <<
+                    (site != GLTRACE_NO_SITE ? (int)site : -1) << "," << time << std::endl;
+                }
+                call++;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Replay failed: " << e.what() << std::endl;
+        pacer.reset();
+        glfwTerminate();
+        return -1;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << std::endl << "Calls" << std::endl;
+    std::cout << std::setw(28) << std::left << "op" << std::right << std::setw(10) << "count" <<
+    std::setw(14) << "total us" << std::setw(12) << "avg us" << std::setw(12) << "max us" << std::endl;
+    for (int i = 0; i < (int)GLTraceOp::Count; i++) {
+        const ReplayStats& stats = opStats[i];
+        if (stats.Count == 0) {
+            continue;
+        }
+        std::cout << std::setw(28) << std::left << GLTrace::GetOpName((GLTraceOp)i) << std::right <<
+        std::setw(10) << stats.Count << std::setw(14) << stats.Total <<
+        std::setw(12) << stats.Total / stats.Count << std::setw(12) << stats.Max << std::endl;
+    }
+
+    std::vector<std::pair<unsigned short, ReplayStats>> hottest(siteStats.begin(), siteStats.end());
+    std::sort(hottest.begin(), hottest.end(), [](const std::pair<unsigned short, ReplayStats>& a, const std::pair<unsigned short, ReplayStats>& b) {
+        return a.second.Total > b.second.Total;
+    });
+    std::cout << std::endl << "Hottest call sites" << std::endl;
+    for (size_t i = 0; i < hottest.size() && i < 10; i++) {
+        const ReplaySite& site = sites[hottest[i].first];
+        std::cout << std::setw(12) << hottest[i].second.Total << " us  " << site.File << ":" << site.Line <<
+        "  " << site.Expression << std::endl;
+    }
+
+    if (!frameTimes.empty()) {
+        std::vector<double> sorted = frameTimes;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (double time : frameTimes) {
+            total += time;
+        }
+        std::cout << std::endl << "Frames " << frameTimes.size() << " (" << header.FrameCount << " per loop)" << std::endl;
+        std::cout << "  avg " << total / frameTimes.size() << " ms" <<
+        "  p50 " << sorted[sorted.size() / 2] << " ms" <<
+        "  p99 " << sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)] << " ms" <<
+        "  max " << sorted.back() << " ms" << std::endl;
+    }
+
+    if (pacing) {
+        std::cout << std::endl << "Latency over the last " << pacer->GetLatencyCount() << " completed frames (" <<
+        pacer->GetMaxFramesInFlight() << " in flight)" << std::endl;
+        std::cout << "  avg " << pacer->GetAverageLatency() << " ms  max " << pacer->GetMaxLatency() << " ms" << std::endl;
+    }
+
+    pacer.reset();
+    glfwTerminate();
+    return 0;
+}
@@ -8,6 +8,7 @@
 
 #include "IndexBuffer.h"
 #include "Renderer.h"
+#include "MemoryTracker.h"
 
 IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
     : m_Count(count)
@@ -15,10 +16,12 @@ IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
     GLCall(glGenBuffers(1, &m_RendererID));
     GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
     GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+    MemoryTracker::Get().Allocate(MemoryCategory::IndexBuffer, m_Count * sizeof(unsigned int));
 }
 
 IndexBuffer::~IndexBuffer() {
     GLCall(glDeleteBuffers(1, &m_RendererID));
+    MemoryTracker::Get().Free(MemoryCategory::IndexBuffer, m_Count * sizeof(unsigned int));
 }
 
 void IndexBuffer::Unbind() const {
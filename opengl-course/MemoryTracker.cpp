@@ -0,0 +1,122 @@
+//
+//  MemoryTracker.cpp
+//  opengl-course
+//
+
+#include "MemoryTracker.h"
+
+#include <algorithm>
+
+#include "Texture.h"
+#include "imgui/imgui.h"
+
+MemoryTracker::MemoryTracker()
+    : m_Usage(), m_Allocations(), m_Peak(0), m_Budget(0), m_IdleFrames(60), m_Frame(0), m_Evictions(0), m_Reloads(0)
+{
+}
+
+MemoryTracker& MemoryTracker::Get() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+void MemoryTracker::Allocate(MemoryCategory category, size_t size) {
+    m_Usage[(int)category] += size;
+    m_Allocations[(int)category]++;
+    m_Peak = std::max(m_Peak, GetTotalUsage());
+}
+
+void MemoryTracker::Free(MemoryCategory category, size_t size) {
+    m_Usage[(int)category] -= std::min(m_Usage[(int)category], size);
+    if (m_Allocations[(int)category] > 0) {
+        m_Allocations[(int)category]--;
+    }
+}
+
+void MemoryTracker::RegisterTexture(Texture* texture) {
+    m_Textures.push_back(texture);
+}
+
+void MemoryTracker::UnregisterTexture(Texture* texture) {
+    m_Textures.erase(std::remove(m_Textures.begin(), m_Textures.end(), texture), m_Textures.end());
+}
+
+void MemoryTracker::NewFrame() {
+    m_Frame++;
+    EnforceBudget();
+}
+
+void MemoryTracker::EnforceBudget() {
+    while (m_Budget > 0 && GetUsage(MemoryCategory::Texture) > m_Budget) {
+        Texture* victim = nullptr;
+        for (Texture* texture : m_Textures) {
+            if (!texture->IsResident() || m_Frame - texture->GetLastBoundFrame() <= m_IdleFrames) {
+                continue;
+            }
+            if (!victim || texture->GetLastBoundFrame() < victim->GetLastBoundFrame()) {
+                victim = texture;
+            }
+        }
+
+        if (!victim) {
+            return;
+        }
+        victim->Evict();
+        m_Evictions++;
+    }
+}
+
+size_t MemoryTracker::GetTotalUsage() const {
+    size_t total = 0;
+    for (int i = 0; i < (int)MemoryCategory::Count; i++) {
+        total += m_Usage[i];
+    }
+    return total;
+}
+
+const char* MemoryTracker::GetCategoryName(MemoryCategory category) {
+    switch (category) {
+        case MemoryCategory::VertexBuffer:  return "Vertex Buffers";
+        case MemoryCategory::IndexBuffer:   return "Index Buffers";
+        case MemoryCategory::Texture:       return "Textures";
+        case MemoryCategory::RenderTarget:  return "Render Targets";
+        case MemoryCategory::Count:         break;
+    }
+    return "Unknown";
+}
+
+void MemoryTracker::OnImGuiRender() {
+    const float kb = 1024.0f;
+
+    ImGui::Begin("Memory");
+    for (int i = 0; i < (int)MemoryCategory::Count; i++) {
+        MemoryCategory category = (MemoryCategory)i;
+        ImGui::Text("%-15s %9.1f KB (%zu)", GetCategoryName(category), GetUsage(category) / kb, GetAllocations(category));
+    }
+    ImGui::Separator();
+    ImGui::Text("%-15s %9.1f KB", "Total", GetTotalUsage() / kb);
+    ImGui::Text("%-15s %9.1f KB", "Peak", m_Peak / kb);
+
+    int budgetKB = (int)(m_Budget / 1024);
+    if (ImGui::InputInt("Texture budget (KB)", &budgetKB, 64, 1024)) {
+        m_Budget = (size_t)std::max(budgetKB, 0) * 1024;
+    }
+    int idleFrames = (int)m_IdleFrames;
+    if (ImGui::InputInt("Evict after frames", &idleFrames)) {
+        m_IdleFrames = (unsigned int)std::max(idleFrames, 0);
+    }
+    if (m_Budget > 0) {
+        float fraction = (float)GetUsage(MemoryCategory::Texture) / (float)m_Budget;
+        ImGui::ProgressBar(std::min(fraction, 1.0f));
+    }
+
+    unsigned int resident = 0;
+    for (Texture* texture : m_Textures) {
+        if (texture->IsResident()) {
+            resident++;
+        }
+    }
+    ImGui::Text("Textures resident: %u / %zu", resident, m_Textures.size());
+    ImGui::Text("Evictions: %u  Reloads: %u", m_Evictions, m_Reloads);
+    ImGui::End();
+}
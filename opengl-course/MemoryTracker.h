@@ -0,0 +1,66 @@
+//
+//  MemoryTracker.h
+//  opengl-course
+//
+
+#ifndef MemoryTracker_h
+#define MemoryTracker_h
+
+#include <cstddef>
+#include <vector>
+
+class Texture;
+
+enum class MemoryCategory {
+    VertexBuffer = 0, IndexBuffer = 1, Texture = 2, RenderTarget = 3, Count = 4
+};
+
+class MemoryTracker {
+private:
+    size_t m_Usage[(int)MemoryCategory::Count];
+    size_t m_Allocations[(int)MemoryCategory::Count];
+    size_t m_Peak;
+    size_t m_Budget;
+    unsigned int m_IdleFrames;
+    unsigned int m_Frame;
+    unsigned int m_Evictions;
+    unsigned int m_Reloads;
+    std::vector<Texture*> m_Textures;
+
+    MemoryTracker();
+public:
+    static MemoryTracker& Get();
+
+    void Allocate(MemoryCategory category, size_t size);
+    void Free(MemoryCategory category, size_t size);
+
+    void RegisterTexture(Texture* texture);
+    void UnregisterTexture(Texture* texture);
+    void OnTextureReload() { m_Reloads++; }
+
+    // Advances the frame counter used to decide which textures were bound recently
+    void NewFrame();
+    // Evicts least recently bound textures until texture usage fits the budget.
+    // Only textures that were not bound for more than the idle frame count are
+    // candidates, so textures in use stay resident even when over budget.
+    void EnforceBudget();
+
+    // Applies to texture memory only, buffers and render targets can't be evicted.
+    // A budget of 0 means unlimited.
+    inline void SetBudget(size_t bytes) { m_Budget = bytes; }
+    inline size_t GetBudget() const { return m_Budget; }
+    inline void SetIdleFrames(unsigned int frames) { m_IdleFrames = frames; }
+    inline unsigned int GetIdleFrames() const { return m_IdleFrames; }
+
+    inline size_t GetUsage(MemoryCategory category) const { return m_Usage[(int)category]; }
+    inline size_t GetAllocations(MemoryCategory category) const { return m_Allocations[(int)category]; }
+    size_t GetTotalUsage() const;
+    inline size_t GetPeakUsage() const { return m_Peak; }
+    inline unsigned int GetFrame() const { return m_Frame; }
+
+    void OnImGuiRender();
+
+    static const char* GetCategoryName(MemoryCategory category);
+};
+
+#endif /* MemoryTracker_h */
@@ -12,13 +12,17 @@
 #include <GL/glew.h>
 #include "signal.h"
 
+#include "GLTraceHooks.h"
+
 #include "VertexArray.h"
 #include "IndexBuffer.h"
 #include "Shader.h"
 
 #define ASSERT(x) if (!(x)) raise(SIGTRAP);
 #define GLCall(x) GLClearError();\
+    GLTrace::BeginCall(#x, __FILE__, __LINE__);\
     x;\
+    GLTrace::EndCall();\
     ASSERT(GLLogCall(#x, __FILE__, __LINE__))
 
 void GLClearError();
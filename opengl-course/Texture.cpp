@@ -9,13 +9,28 @@
 #include "Texture.h"
 
 #include "Renderer.h"
+#include "MemoryTracker.h"
 #include "stb_image/stb_image.h"
 
 Texture::Texture(const std::string& path)
-    : m_RendererID(0), m_FilePath(path), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0)
+    : m_RendererID(0), m_FilePath(path), m_LocalBuffer(nullptr), m_Width(0), m_Height(0), m_BPP(0), m_LastBoundFrame(0)
 {
+    Load();
+    
+    MemoryTracker& tracker = MemoryTracker::Get();
+    m_LastBoundFrame = tracker.GetFrame();
+    tracker.RegisterTexture(this);
+    tracker.EnforceBudget();
+}
+
+Texture::~Texture() {
+    MemoryTracker::Get().UnregisterTexture(this);
+    Evict();
+}
+
+void Texture::Load() {
     stbi_set_flip_vertically_on_load(1);
-    m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, STBI_rgb_alpha);
+    m_LocalBuffer = stbi_load(m_FilePath.c_str(), &m_Width, &m_Height, &m_BPP, STBI_rgb_alpha);
     
     GLCall(glGenTextures(1, &m_RendererID));
     GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
@@ -30,14 +45,31 @@ Texture::Texture(const std::string& path)
     
     if (m_LocalBuffer) {
         stbi_image_free(m_LocalBuffer);
+        m_LocalBuffer = nullptr;
     }
+    
+    MemoryTracker::Get().Allocate(MemoryCategory::Texture, GetSize());
 }
 
-Texture::~Texture() {
+void Texture::Evict() {
+    if (!IsResident()) {
+        return;
+    }
+    
     GLCall(glDeleteTextures(1, &m_RendererID));
+    m_RendererID = 0;
+    MemoryTracker::Get().Free(MemoryCategory::Texture, GetSize());
 }
 
-void Texture::Bind(unsigned int slot /*= 0*/) const {
+void Texture::Bind(unsigned int slot /*= 0*/) {
+    MemoryTracker& tracker = MemoryTracker::Get();
+    m_LastBoundFrame = tracker.GetFrame();
+    if (!IsResident()) {
+        Load();
+        tracker.OnTextureReload();
+        tracker.EnforceBudget();
+    }
+    
     GLCall(glActiveTexture(GL_TEXTURE0 + slot));
     GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
 }
@@ -17,15 +17,25 @@ private:
     std::string m_FilePath;
     unsigned char* m_LocalBuffer;
     int m_Width, m_Height, m_BPP;
+    unsigned int m_LastBoundFrame;
 public:
     Texture(const std::string& path);
     ~Texture();
     
-    void Bind(unsigned int slot = 0) const;
+    // Reloads the texture from its source path if it was evicted
+    void Bind(unsigned int slot = 0);
     void Unbind() const;
     
+    // Releases the GPU storage, the next Bind() will reload it
+    void Evict();
+    
     inline int GetWidth() const { return m_Width; }
     inline int GetHeight() const { return m_Height; }
+    inline bool IsResident() const { return m_RendererID != 0; }
+    inline unsigned int GetLastBoundFrame() const { return m_LastBoundFrame; }
+    inline size_t GetSize() const { return (size_t)m_Width * m_Height * 4; }
+private:
+    void Load();
 };
 
 #endif /* Texture_h */
@@ -8,15 +8,20 @@
 
 #include "VertexBuffer.h"
 #include "Renderer.h"
+#include "MemoryTracker.h"
 
-VertexBuffer::VertexBuffer(const void* data, unsigned int size) {
+VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+    : m_Size(size)
+{
     GLCall(glGenBuffers(1, &m_RendererID));
     GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
     GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    MemoryTracker::Get().Allocate(MemoryCategory::VertexBuffer, m_Size);
 }
 
 VertexBuffer::~VertexBuffer() {
     GLCall(glDeleteBuffers(1, &m_RendererID));
+    MemoryTracker::Get().Free(MemoryCategory::VertexBuffer, m_Size);
 }
 
 void VertexBuffer::Unbind() const {